@@ -4,6 +4,31 @@
 #include <iomanip>
 #include <cstring>   // std::memcmp
 #include <cmath>     // std::fma
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <filesystem>
+#include <memory>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define SAXPY_HAVE_POSIX_IO 1
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   include <cerrno>
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#endif
+
+// x86 + GCC/Clang: SIMD widening kernels are built with target attributes
+// and selected at run time, so no -march flag is needed
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#   define SAXPY_X86_DISPATCH 1
+#   include <immintrin.h>
+#endif
 
 // -----------------------------------------------------------------------------
 //  Baseline:  out[i] = a[i] * 2 + b[i] * 3 - 10
@@ -34,6 +59,332 @@ void saxpy_fma(const float* __restrict a,
         out[i] = std::fma(b[i], C2, std::fma(a[i], C1, C3));
 }
 
+// -----------------------------------------------------------------------------
+//  Reduced‑precision storage
+//
+//  At 16 M elements the kernels above are memory‑bound: 12 bytes of traffic
+//  for three FLOPs per element.  Below, `a`/`b` are kept in 16‑bit (bf16,
+//  fp16) or 8‑bit (scaled int8) form and widened to float in registers; `out`
+//  stays float.  Each buffer carries a scale so that
+//      a[i] ≈ decode(qa[i]) * sa
+//  and the scale is folded into the coefficients:
+//      out[i] = fma(qb[i], 3*sb, fma(qa[i], 2*sa, -10))
+// -----------------------------------------------------------------------------
+inline std::uint32_t float_bits(float f)
+{
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof u);
+    return u;
+}
+
+inline float bits_float(std::uint32_t u)
+{
+    float f;
+    std::memcpy(&f, &u, sizeof f);
+    return f;
+}
+
+// bf16 = upper half of an IEEE float, round‑to‑nearest‑even
+inline std::uint16_t float_to_bf16(float f)
+{
+    std::uint32_t u = float_bits(f);
+    if ((u & 0x7fffffffu) > 0x7f800000u)                   // NaN: keep it quiet
+        return static_cast<std::uint16_t>((u >> 16) | 0x40u);
+    u += 0x7fffu + ((u >> 16) & 1u);
+    return static_cast<std::uint16_t>(u >> 16);
+}
+
+inline float bf16_to_float(std::uint16_t h)
+{
+    return bits_float(static_cast<std::uint32_t>(h) << 16);
+}
+
+// IEEE binary16, round‑to‑nearest‑even (software path, used for encoding)
+inline std::uint16_t float_to_fp16(float f)
+{
+    const std::uint32_t u    = float_bits(f);
+    const std::uint32_t sign = (u >> 16) & 0x8000u;
+    const std::uint32_t absu = u & 0x7fffffffu;
+
+    if (absu >= 0x7f800000u)                               // Inf / NaN
+        return static_cast<std::uint16_t>(sign | 0x7c00u | (absu > 0x7f800000u ? 0x200u : 0u));
+    if (absu >= 0x477ff000u)                               // rounds past 65504
+        return static_cast<std::uint16_t>(sign | 0x7c00u);
+    if (absu < 0x38800000u)                                // half subnormal / zero
+        return static_cast<std::uint16_t>(
+            sign | static_cast<std::uint32_t>(std::nearbyint(bits_float(absu) * 16777216.0f)));
+
+    const std::uint32_t r = absu + 0xfffu + ((absu >> 13) & 1u);
+    return static_cast<std::uint16_t>(sign | ((r - 0x38000000u) >> 13));
+}
+
+inline float fp16_to_float(std::uint16_t h)
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    const std::uint32_t exp  = (h >> 10) & 0x1fu;
+    const std::uint32_t mant = h & 0x3ffu;
+
+    if (exp == 0) {                                        // subnormal / zero
+        const float v = static_cast<float>(mant) * (1.0f / 16777216.0f);
+        return sign ? -v : v;
+    }
+    if (exp == 31)
+        return bits_float(sign | 0x7f800000u | (mant << 13));
+    return bits_float(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+template <typename T>
+struct Encoded {
+    std::vector<T> q;
+    float scale = 1.0f;
+};
+
+inline float max_abs(const std::vector<float>& v)
+{
+    float m = 0.0f;
+    for (float x : v) m = std::max(m, std::abs(x));
+    return m;
+}
+
+// bf16 has float's exponent range – no scaling needed
+Encoded<std::uint16_t> encode_bf16(const std::vector<float>& v)
+{
+    Encoded<std::uint16_t> e;
+    e.q.resize(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) e.q[i] = float_to_bf16(v[i]);
+    return e;
+}
+
+// fp16 tops out at 65504: pick a power‑of‑two scale (exact) so that
+// max|v| / scale < 2^15
+Encoded<std::uint16_t> encode_fp16(const std::vector<float>& v)
+{
+    Encoded<std::uint16_t> e;
+    const float m = max_abs(v);
+    if (m > 0.0f) e.scale = std::ldexp(1.0f, std::max(0, std::ilogb(m) - 14));
+    e.q.resize(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) e.q[i] = float_to_fp16(v[i] / e.scale);
+    return e;
+}
+
+// symmetric linear quantisation to [-127, 127]
+Encoded<std::int8_t> encode_i8(const std::vector<float>& v)
+{
+    Encoded<std::int8_t> e;
+    const float m = max_abs(v);
+    if (m > 0.0f) e.scale = m / 127.0f;
+    e.q.resize(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        e.q[i] = static_cast<std::int8_t>(std::clamp(std::nearbyint(v[i] / e.scale), -127.0f, 127.0f));
+    return e;
+}
+
+// -----------------------------------------------------------------------------
+//  Widening kernels.  The AVX2 + F16C and AVX‑512 bodies are compiled with
+//  target attributes and chosen once at start‑up from CPUID, so the default
+//  (portable) build still uses the vector units when the CPU has them.  Each
+//  SIMD body returns how many elements it handled; the scalar loop does the
+//  rest (or everything, on other CPUs / compilers).
+// -----------------------------------------------------------------------------
+enum class WidenPath { Scalar, Avx2, Avx512 };
+
+WidenPath detect_widen_path()
+{
+#if defined(SAXPY_X86_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return WidenPath::Avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c") &&
+        __builtin_cpu_supports("fma"))
+        return WidenPath::Avx2;
+#endif
+    return WidenPath::Scalar;
+}
+
+const WidenPath widen_path = detect_widen_path();
+
+const char* widen_path_name(WidenPath p)
+{
+    switch (p) {
+        case WidenPath::Avx512: return "AVX-512";
+        case WidenPath::Avx2:   return "AVX2 + F16C";
+        default:                return "scalar";
+    }
+}
+
+#if defined(SAXPY_X86_DISPATCH)
+#   define SAXPY_TARGET_AVX2   __attribute__((target("avx2,f16c,fma")))
+#   define SAXPY_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// ---- float32 (reference for the storage‑format table) -----------------------
+SAXPY_TARGET_AVX512
+std::size_t saxpy_f32_avx512(const float* a, const float* b, float* out, std::size_t n)
+{
+    const __m512 va_c = _mm512_set1_ps(2.0f), vb_c = _mm512_set1_ps(3.0f), v0 = _mm512_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x = _mm512_loadu_ps(a + i);
+        __m512 y = _mm512_loadu_ps(b + i);
+        _mm512_storeu_ps(out + i, _mm512_fmadd_ps(y, vb_c, _mm512_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+SAXPY_TARGET_AVX2
+std::size_t saxpy_f32_avx2(const float* a, const float* b, float* out, std::size_t n)
+{
+    const __m256 va_c = _mm256_set1_ps(2.0f), vb_c = _mm256_set1_ps(3.0f), v0 = _mm256_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(a + i);
+        __m256 y = _mm256_loadu_ps(b + i);
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(y, vb_c, _mm256_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+// ---- bf16: zero‑extend to 32 bits and shift into the high half --------------
+SAXPY_TARGET_AVX512
+std::size_t saxpy_bf16_avx512(const std::uint16_t* a, float ca, const std::uint16_t* b, float cb,
+                              float* out, std::size_t n)
+{
+    const __m512 va_c = _mm512_set1_ps(ca), vb_c = _mm512_set1_ps(cb), v0 = _mm512_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x = _mm512_castsi512_ps(_mm512_slli_epi32(
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))), 16));
+        __m512 y = _mm512_castsi512_ps(_mm512_slli_epi32(
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))), 16));
+        _mm512_storeu_ps(out + i, _mm512_fmadd_ps(y, vb_c, _mm512_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+SAXPY_TARGET_AVX2
+std::size_t saxpy_bf16_avx2(const std::uint16_t* a, float ca, const std::uint16_t* b, float cb,
+                            float* out, std::size_t n)
+{
+    const __m256 va_c = _mm256_set1_ps(ca), vb_c = _mm256_set1_ps(cb), v0 = _mm256_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))), 16));
+        __m256 y = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))), 16));
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(y, vb_c, _mm256_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+// ---- fp16: vcvtph2ps --------------------------------------------------------
+SAXPY_TARGET_AVX512
+std::size_t saxpy_fp16_avx512(const std::uint16_t* a, float ca, const std::uint16_t* b, float cb,
+                              float* out, std::size_t n)
+{
+    const __m512 va_c = _mm512_set1_ps(ca), vb_c = _mm512_set1_ps(cb), v0 = _mm512_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x = _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        __m512 y = _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        _mm512_storeu_ps(out + i, _mm512_fmadd_ps(y, vb_c, _mm512_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+SAXPY_TARGET_AVX2
+std::size_t saxpy_fp16_avx2(const std::uint16_t* a, float ca, const std::uint16_t* b, float cb,
+                            float* out, std::size_t n)
+{
+    const __m256 va_c = _mm256_set1_ps(ca), vb_c = _mm256_set1_ps(cb), v0 = _mm256_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        __m256 y = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(y, vb_c, _mm256_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+// ---- int8: sign‑extend to 32 bits and convert -------------------------------
+SAXPY_TARGET_AVX512
+std::size_t saxpy_i8_avx512(const std::int8_t* a, float ca, const std::int8_t* b, float cb,
+                            float* out, std::size_t n)
+{
+    const __m512 va_c = _mm512_set1_ps(ca), vb_c = _mm512_set1_ps(cb), v0 = _mm512_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))));
+        __m512 y = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+        _mm512_storeu_ps(out + i, _mm512_fmadd_ps(y, vb_c, _mm512_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+
+SAXPY_TARGET_AVX2
+std::size_t saxpy_i8_avx2(const std::int8_t* a, float ca, const std::int8_t* b, float cb,
+                          float* out, std::size_t n)
+{
+    const __m256 va_c = _mm256_set1_ps(ca), vb_c = _mm256_set1_ps(cb), v0 = _mm256_set1_ps(-10.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i))));
+        __m256 y = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i))));
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(y, vb_c, _mm256_fmadd_ps(x, va_c, v0)));
+    }
+    return i;
+}
+#endif // SAXPY_X86_DISPATCH
+
+// Pick the SIMD body for this CPU (if any), finish with the scalar loop.
+#if defined(SAXPY_X86_DISPATCH)
+#   define SAXPY_WIDEN(fmt, ...)                                              \
+        (widen_path == WidenPath::Avx512 ? saxpy_##fmt##_avx512(__VA_ARGS__) : \
+         widen_path == WidenPath::Avx2   ? saxpy_##fmt##_avx2(__VA_ARGS__)   : \
+                                           std::size_t(0))
+#else
+#   define SAXPY_WIDEN(fmt, ...) std::size_t(0)
+#endif
+
+// Same arithmetic as saxpy_fma, float storage, same dispatch as the narrow formats.
+void saxpy_f32(const float* __restrict a,
+               const float* __restrict b,
+               float* __restrict out,
+               std::size_t n)
+{
+    for (std::size_t i = SAXPY_WIDEN(f32, a, b, out, n); i < n; ++i)
+        out[i] = std::fma(b[i], 3.0f, std::fma(a[i], 2.0f, -10.0f));
+}
+
+void saxpy_bf16(const std::uint16_t* __restrict a, float sa,
+                const std::uint16_t* __restrict b, float sb,
+                float* __restrict out,
+                std::size_t n)
+{
+    const float ca = 2.0f * sa, cb = 3.0f * sb, c0 = -10.0f;
+    for (std::size_t i = SAXPY_WIDEN(bf16, a, ca, b, cb, out, n); i < n; ++i)
+        out[i] = std::fma(bf16_to_float(b[i]), cb, std::fma(bf16_to_float(a[i]), ca, c0));
+}
+
+void saxpy_fp16(const std::uint16_t* __restrict a, float sa,
+                const std::uint16_t* __restrict b, float sb,
+                float* __restrict out,
+                std::size_t n)
+{
+    const float ca = 2.0f * sa, cb = 3.0f * sb, c0 = -10.0f;
+    for (std::size_t i = SAXPY_WIDEN(fp16, a, ca, b, cb, out, n); i < n; ++i)
+        out[i] = std::fma(fp16_to_float(b[i]), cb, std::fma(fp16_to_float(a[i]), ca, c0));
+}
+
+void saxpy_i8(const std::int8_t* __restrict a, float sa,
+              const std::int8_t* __restrict b, float sb,
+              float* __restrict out,
+              std::size_t n)
+{
+    const float ca = 2.0f * sa, cb = 3.0f * sb, c0 = -10.0f;
+    for (std::size_t i = SAXPY_WIDEN(i8, a, ca, b, cb, out, n); i < n; ++i)
+        out[i] = std::fma(static_cast<float>(b[i]), cb, std::fma(static_cast<float>(a[i]), ca, c0));
+}
+
 // -----------------------------------------------------------------------------
 //  Timing helper
 // -----------------------------------------------------------------------------
@@ -50,11 +401,495 @@ double time_it(F&& fun, const char* tag)
     return secs;
 }
 
+// -----------------------------------------------------------------------------
+//  Bandwidth report for the storage‑format comparison.
+//  Best of `reps` runs; `bytes_per_elem` counts the a + b reads and out write.
+// -----------------------------------------------------------------------------
+template <typename F>
+void time_bw(F&& fun, const char* tag, std::size_t n, std::size_t bytes_per_elem,
+             const std::vector<float>& out, const std::vector<float>& ref,
+             int reps = 5)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        fun();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+
+    double max_abs_err = 0.0, max_rel_err = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double err = std::abs(static_cast<double>(out[i]) - ref[i]);
+        max_abs_err = std::max(max_abs_err, err);
+        if (ref[i] != 0.0f)
+            max_rel_err = std::max(max_rel_err, err / std::abs(static_cast<double>(ref[i])));
+    }
+
+    std::cout << std::left  << std::setw(12) << tag << " : "
+              << std::fixed << std::setprecision(6) << best << " s"
+              << std::right << std::setprecision(2)
+              << std::setw(9) << static_cast<double>(n * bytes_per_elem) / best * 1e-9 << " GB/s"
+              << std::setw(9) << static_cast<double>(n) / best * 1e-9 << " Gelem/s"
+              << std::scientific << std::setprecision(3)
+              << "   max abs err " << max_abs_err
+              << "   max rel err " << max_rel_err << '\n'
+              << std::defaultfloat;
+}
+
+// -----------------------------------------------------------------------------
+//  Out‑of‑core streaming  (POSIX only)
+//
+//  a.bin / b.bin / out.bin are raw float arrays on disk and never have to fit
+//  in memory.  A reader thread fills `depth` chunk slots with pread (or
+//  O_DIRECT), the main thread runs saxpy_fma on each filled slot and a writer
+//  thread pwrites the result back, so disk transfers and compute overlap.
+//  An mmap + MADV_SEQUENTIAL mode runs the same kernel for comparison.
+// -----------------------------------------------------------------------------
+#if defined(SAXPY_HAVE_POSIX_IO)
+
+constexpr std::size_t IO_ALIGN = 4096;        // O_DIRECT wants block‑aligned I/O
+
+struct FreeDeleter {
+    void operator()(float* p) const { std::free(p); }
+};
+using AlignedFloats = std::unique_ptr<float[], FreeDeleter>;
+
+AlignedFloats alloc_aligned(std::size_t n)
+{
+    void* raw = nullptr;
+    if (posix_memalign(&raw, IO_ALIGN, n * sizeof(float)) != 0)
+        throw std::bad_alloc();
+    return AlignedFloats(static_cast<float*>(raw));
+}
+
+// pread/pwrite until `len` bytes are transferred (or EOF); -1 on error
+ssize_t pread_full(int fd, void* buf, std::size_t len, off_t off)
+{
+    std::size_t done = 0;
+    while (done < len) {
+        ssize_t r = ::pread(fd, static_cast<char*>(buf) + done, len - done,
+                            off + static_cast<off_t>(done));
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return -1;
+        if (r == 0) break;
+        done += static_cast<std::size_t>(r);
+    }
+    return static_cast<ssize_t>(done);
+}
+
+ssize_t pwrite_full(int fd, const void* buf, std::size_t len, off_t off)
+{
+    std::size_t done = 0;
+    while (done < len) {
+        ssize_t r = ::pwrite(fd, static_cast<const char*>(buf) + done, len - done,
+                             off + static_cast<off_t>(done));
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return -1;
+        done += static_cast<std::size_t>(r);
+    }
+    return static_cast<ssize_t>(done);
+}
+
+struct StreamConfig {
+    std::filesystem::path dir;
+    std::size_t n      = 0;                   // elements per file
+    std::size_t chunk  = 0;                   // elements per chunk (multiple of IO_ALIGN / 4)
+    std::size_t depth  = 3;                   // 2 = double, 3 = triple buffering
+    bool        direct = false;               // O_DIRECT for the pread pipeline
+};
+
+struct StreamFiles {
+    int a = -1, b = -1, out = -1;
+    ~StreamFiles()
+    {
+        for (int fd : {a, b, out})
+            if (fd >= 0) ::close(fd);
+    }
+};
+
+struct StreamResult {
+    double secs    = 0.0;                     // end to end, including the final fsync
+    double compute = 0.0;                     // time spent inside saxpy_fma
+    bool   ok      = false;
+};
+
+// bytes moved for a chunk of `count` elements; O_DIRECT rounds up to a block
+std::size_t io_bytes(std::size_t count, bool direct)
+{
+    const std::size_t bytes = count * sizeof(float);
+    return direct ? (bytes + IO_ALIGN - 1) / IO_ALIGN * IO_ALIGN : bytes;
+}
+
+off_t chunk_offset(const StreamConfig& cfg, std::size_t c)
+{
+    return static_cast<off_t>(c * cfg.chunk * sizeof(float));
+}
+
+bool open_stream_files(const StreamConfig& cfg, bool direct, StreamFiles& f)
+{
+    int extra = 0;
+#if defined(O_DIRECT)
+    if (direct) extra = O_DIRECT;
+#else
+    (void)direct;
+#endif
+    f.a   = ::open((cfg.dir / "a.bin").c_str(),   O_RDONLY | extra);
+    f.b   = ::open((cfg.dir / "b.bin").c_str(),   O_RDONLY | extra);
+    f.out = ::open((cfg.dir / "out.bin").c_str(), O_RDWR | O_CREAT | O_TRUNC | extra, 0644);
+    if (f.a < 0 || f.b < 0 || f.out < 0) {
+        std::cerr << "stream: open failed: " << std::strerror(errno) << '\n';
+        return false;
+    }
+    return true;
+}
+
+// Push dirty pages to disk and evict the files from the page cache so every
+// mode starts cold.  Best effort: not every platform has posix_fadvise.
+void drop_cache(const StreamConfig& cfg)
+{
+    for (const char* name : {"a.bin", "b.bin", "out.bin"}) {
+        int fd = ::open((cfg.dir / name).c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        ::fsync(fd);
+#if defined(POSIX_FADV_DONTNEED)
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+        ::close(fd);
+    }
+}
+
+// Write a.bin / b.bin with the same pattern as the in‑memory driver, unless
+// files of the right size are already there.
+bool prepare_inputs(const StreamConfig& cfg)
+{
+    std::filesystem::create_directories(cfg.dir);
+
+    const std::uintmax_t want = cfg.n * sizeof(float);
+    std::error_code ec;
+    if (std::filesystem::file_size(cfg.dir / "a.bin", ec) == want &&
+        std::filesystem::file_size(cfg.dir / "b.bin", ec) == want)
+        return true;
+
+    std::cout << "generating " << (want >> 20) << " MiB inputs in " << cfg.dir << " ...\n";
+    std::vector<float> buf(cfg.chunk);
+    for (const auto& [name, k] : {std::pair{"a.bin", 0.1f}, std::pair{"b.bin", 0.2f}}) {
+        int fd = ::open((cfg.dir / name).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "stream: cannot create " << name << ": " << std::strerror(errno) << '\n';
+            return false;
+        }
+        for (std::size_t i0 = 0; i0 < cfg.n; i0 += cfg.chunk) {
+            const std::size_t count = std::min(cfg.chunk, cfg.n - i0);
+            for (std::size_t j = 0; j < count; ++j)
+                buf[j] = k * static_cast<float>(i0 + j);
+            if (pwrite_full(fd, buf.data(), count * sizeof(float),
+                            static_cast<off_t>(i0 * sizeof(float))) < 0) {
+                std::cerr << "stream: write " << name << ": " << std::strerror(errno) << '\n';
+                ::close(fd);
+                return false;
+            }
+        }
+        ::close(fd);
+    }
+    return true;
+}
+
+// One thread, no overlap: read → compute → write per chunk.
+StreamResult stream_serial(const StreamConfig& cfg)
+{
+    StreamResult res;
+    StreamFiles f;
+    if (!open_stream_files(cfg, cfg.direct, f)) return res;
+
+    AlignedFloats a = alloc_aligned(cfg.chunk), b = alloc_aligned(cfg.chunk),
+                  out = alloc_aligned(cfg.chunk);
+    const std::size_t n_chunks = (cfg.n + cfg.chunk - 1) / cfg.chunk;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t c = 0; c < n_chunks; ++c) {
+        const std::size_t count = std::min(cfg.chunk, cfg.n - c * cfg.chunk);
+        const std::size_t len   = io_bytes(count, cfg.direct);
+        if (pread_full(f.a, a.get(), len, chunk_offset(cfg, c)) < static_cast<ssize_t>(count * sizeof(float)) ||
+            pread_full(f.b, b.get(), len, chunk_offset(cfg, c)) < static_cast<ssize_t>(count * sizeof(float))) {
+            std::cerr << "stream: short read in chunk " << c << '\n';
+            return res;
+        }
+        auto k0 = std::chrono::steady_clock::now();
+        saxpy_fma(a.get(), b.get(), out.get(), count);
+        res.compute += std::chrono::duration<double>(std::chrono::steady_clock::now() - k0).count();
+        if (pwrite_full(f.out, out.get(), len, chunk_offset(cfg, c)) < 0) {
+            std::cerr << "stream: write failed: " << std::strerror(errno) << '\n';
+            return res;
+        }
+    }
+    res.ok = ::ftruncate(f.out, static_cast<off_t>(cfg.n * sizeof(float))) == 0 &&
+             ::fsync(f.out) == 0;
+    res.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+// Reader thread → compute (this thread) → writer thread, `depth` slots in flight.
+// With compute == false the kernel is skipped and the writer stores the `a`
+// chunk instead: the same overlapped I/O, i.e. the disk reference for the pipeline.
+StreamResult stream_pipelined(const StreamConfig& cfg, bool compute = true)
+{
+    struct Slot {
+        enum State { Free, Loaded, Computed } state = Free;
+        std::size_t   count = 0;
+        AlignedFloats a, b, out;
+    };
+
+    StreamResult res;
+    StreamFiles f;
+    if (!open_stream_files(cfg, cfg.direct, f)) return res;
+
+    std::vector<Slot> slots(cfg.depth);
+    for (Slot& s : slots) {
+        s.a   = alloc_aligned(cfg.chunk);
+        s.b   = alloc_aligned(cfg.chunk);
+        s.out = alloc_aligned(cfg.chunk);
+    }
+    const std::size_t n_chunks = (cfg.n + cfg.chunk - 1) / cfg.chunk;
+
+    std::mutex              m;
+    std::condition_variable cv;
+    bool                    failed = false;
+
+    // block until slot `s` reaches `want` (or a stage failed); false on failure
+    auto wait_for = [&](Slot& s, Slot::State want) {
+        std::unique_lock<std::mutex> lk(m);
+        cv.wait(lk, [&] { return s.state == want || failed; });
+        return !failed;
+    };
+    auto publish = [&](Slot& s, Slot::State next, bool ok) {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            if (ok) s.state = next;
+            else    failed  = true;
+        }
+        cv.notify_all();
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::thread reader([&] {
+        for (std::size_t c = 0; c < n_chunks; ++c) {
+            Slot& s = slots[c % cfg.depth];
+            if (!wait_for(s, Slot::Free)) return;
+            s.count = std::min(cfg.chunk, cfg.n - c * cfg.chunk);
+            const std::size_t len  = io_bytes(s.count, cfg.direct);
+            const ssize_t     need = static_cast<ssize_t>(s.count * sizeof(float));
+            const bool ok = pread_full(f.a, s.a.get(), len, chunk_offset(cfg, c)) >= need &&
+                            pread_full(f.b, s.b.get(), len, chunk_offset(cfg, c)) >= need;
+            if (!ok) std::cerr << "stream: short read in chunk " << c << '\n';
+            publish(s, Slot::Loaded, ok);
+            if (!ok) return;
+        }
+    });
+
+    std::thread writer([&] {
+        for (std::size_t c = 0; c < n_chunks; ++c) {
+            Slot& s = slots[c % cfg.depth];
+            if (!wait_for(s, Slot::Computed)) return;
+            const bool ok = pwrite_full(f.out, compute ? s.out.get() : s.a.get(),
+                                        io_bytes(s.count, cfg.direct), chunk_offset(cfg, c)) >= 0;
+            if (!ok) std::cerr << "stream: write failed: " << std::strerror(errno) << '\n';
+            publish(s, Slot::Free, ok);
+            if (!ok) return;
+        }
+    });
+
+    for (std::size_t c = 0; c < n_chunks; ++c) {
+        Slot& s = slots[c % cfg.depth];
+        if (!wait_for(s, Slot::Loaded)) break;
+        if (compute) {
+            auto k0 = std::chrono::steady_clock::now();
+            saxpy_fma(s.a.get(), s.b.get(), s.out.get(), s.count);
+            res.compute += std::chrono::duration<double>(std::chrono::steady_clock::now() - k0).count();
+        }
+        publish(s, Slot::Computed, true);
+    }
+
+    reader.join();
+    writer.join();
+
+    res.ok = !failed &&
+             ::ftruncate(f.out, static_cast<off_t>(cfg.n * sizeof(float))) == 0 &&
+             ::fsync(f.out) == 0;
+    res.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+// Map all three files and let the kernel page through them; the kernel still
+// runs chunk by chunk so the page cache can evict behind it.
+StreamResult stream_mmap(const StreamConfig& cfg)
+{
+    StreamResult res;
+    StreamFiles f;
+    if (!open_stream_files(cfg, false, f)) return res;
+
+    const std::size_t bytes = cfg.n * sizeof(float);
+    if (::ftruncate(f.out, static_cast<off_t>(bytes)) != 0) {
+        std::cerr << "stream: ftruncate failed: " << std::strerror(errno) << '\n';
+        return res;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    void* pa = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, f.a, 0);
+    void* pb = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, f.b, 0);
+    void* po = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, f.out, 0);
+    if (pa == MAP_FAILED || pb == MAP_FAILED || po == MAP_FAILED) {
+        std::cerr << "stream: mmap failed: " << std::strerror(errno) << '\n';
+        for (void* p : {pa, pb, po})
+            if (p != MAP_FAILED) ::munmap(p, bytes);
+        return res;
+    }
+    for (void* p : {pa, pb, po})
+        ::madvise(p, bytes, MADV_SEQUENTIAL);
+
+    const float* a   = static_cast<const float*>(pa);
+    const float* b   = static_cast<const float*>(pb);
+    float*       out = static_cast<float*>(po);
+    for (std::size_t i0 = 0; i0 < cfg.n; i0 += cfg.chunk) {
+        const std::size_t count = std::min(cfg.chunk, cfg.n - i0);
+        auto k0 = std::chrono::steady_clock::now();
+        saxpy_fma(a + i0, b + i0, out + i0, count);     // includes page‑fault I/O
+        res.compute += std::chrono::duration<double>(std::chrono::steady_clock::now() - k0).count();
+    }
+
+    res.ok = ::msync(po, bytes, MS_SYNC) == 0;
+    for (void* p : {pa, pb, po})
+        ::munmap(p, bytes);
+    res.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+// Spot‑check out.bin against a/b at evenly spaced indices.
+bool verify_stream(const StreamConfig& cfg)
+{
+    StreamFiles f;
+    f.a   = ::open((cfg.dir / "a.bin").c_str(),   O_RDONLY);
+    f.b   = ::open((cfg.dir / "b.bin").c_str(),   O_RDONLY);
+    f.out = ::open((cfg.dir / "out.bin").c_str(), O_RDONLY);
+    if (f.a < 0 || f.b < 0 || f.out < 0) return false;
+
+    constexpr std::size_t SAMPLES = 1024;
+    for (std::size_t s = 0; s < SAMPLES; ++s) {
+        const std::size_t i   = s * (cfg.n - 1) / (SAMPLES - 1);
+        const off_t       off = static_cast<off_t>(i * sizeof(float));
+        float a = 0, b = 0, o = 0;
+        if (pread_full(f.a, &a, sizeof a, off) != sizeof a ||
+            pread_full(f.b, &b, sizeof b, off) != sizeof b ||
+            pread_full(f.out, &o, sizeof o, off) != sizeof o)
+            return false;
+        if (o != std::fma(b, 3.0f, std::fma(a, 2.0f, -10.0f)))
+            return false;
+    }
+    return true;
+}
+
+void report_stream(const char* tag, const StreamResult& r, std::size_t bytes, bool verified)
+{
+    std::cout << std::left  << std::setw(26) << tag << " : "
+              << std::fixed << std::setprecision(3) << r.secs << " s"
+              << std::right << std::setprecision(2)
+              << std::setw(9) << static_cast<double>(bytes) / r.secs * 1e-9 << " GB/s"
+              << (r.ok ? (verified ? "" : "   (VERIFY FAILED)") : "   (I/O FAILED)") << '\n'
+              << std::defaultfloat;
+}
+
+// Upper bounds for the command line: `depth` slots of three chunks are
+// allocated up front, and "-1" parses to SIZE_MAX with strtoull.
+constexpr std::size_t MAX_STREAM_MIB   = std::size_t(1) << 24;   // 16 TiB per file
+constexpr std::size_t MAX_CHUNK_MIB    = 1024;
+constexpr std::size_t MAX_STREAM_DEPTH = 64;
+
+// usage: <exe> stream <dir> [MiB per file = 1024] [chunk MiB = 8] [depth = 3] [direct]
+// (argv is main's, so argv[1] is "stream")
+int stream_main(int argc, char* argv[])
+{
+    StreamConfig cfg;
+    cfg.dir = argc > 2 ? argv[2] : "stream_data";
+    const std::size_t mib       = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1024;
+    const std::size_t chunk_mib = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 8;
+    cfg.depth  = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 3;
+    cfg.direct = argc > 6 && std::strcmp(argv[6], "direct") == 0;
+
+    if (mib == 0 || mib > MAX_STREAM_MIB || chunk_mib == 0 || chunk_mib > MAX_CHUNK_MIB ||
+        cfg.depth < 2 || cfg.depth > MAX_STREAM_DEPTH) {
+        std::cerr << "usage: " << argv[0] << " stream <dir> [MiB per file <= " << MAX_STREAM_MIB
+                  << "] [chunk MiB <= " << MAX_CHUNK_MIB << "] [depth 2.." << MAX_STREAM_DEPTH
+                  << "] [direct]\n";
+        return 1;
+    }
+    cfg.n     = (mib << 20) / sizeof(float);
+    cfg.chunk = (chunk_mib << 20) / sizeof(float);
+#if !defined(O_DIRECT)
+    if (cfg.direct) {
+        std::cerr << "stream: O_DIRECT not available, using buffered pread\n";
+        cfg.direct = false;
+    }
+#endif
+    if (!prepare_inputs(cfg)) return 1;
+
+    // a + b read, out written
+    const std::size_t bytes = 3 * cfg.n * sizeof(float);
+
+    std::cout << "stream: " << mib << " MiB per file, chunk " << chunk_mib << " MiB, depth "
+              << cfg.depth << ", " << (cfg.direct ? "O_DIRECT" : "buffered") << " pread\n";
+
+    drop_cache(cfg);
+    const StreamResult raw = stream_pipelined(cfg, false);
+    report_stream("pipelined I/O (no compute)", raw, bytes, true);
+
+    drop_cache(cfg);
+    const StreamResult serial = stream_serial(cfg);
+    report_stream("serial read/compute/write", serial, bytes, serial.ok && verify_stream(cfg));
+
+    drop_cache(cfg);
+    const StreamResult piped = stream_pipelined(cfg);
+    report_stream("pipelined pread", piped, bytes, piped.ok && verify_stream(cfg));
+
+    drop_cache(cfg);
+    const StreamResult mapped = stream_mmap(cfg);
+    report_stream("mmap + MADV_SEQUENTIAL", mapped, bytes, mapped.ok && verify_stream(cfg));
+
+    if (!(raw.ok && serial.ok && piped.ok && mapped.ok)) return 1;
+
+    // How much of the kernel time disappeared behind I/O in the pipeline:
+    // whatever the pipeline took beyond the same pipeline without the kernel.
+    // n/a when the kernel time rounds to zero (tiny inputs).
+    std::cout << std::fixed << std::setprecision(3)
+              << "\ncompute time (pipelined) : " << piped.compute << " s\n"
+              << std::setprecision(1)
+              << "compute hidden behind I/O: ";
+    if (piped.compute > 0.0)
+        std::cout << 100.0 * std::clamp(1.0 - (piped.secs - raw.secs) / piped.compute, 0.0, 1.0)
+                  << " %\n";
+    else
+        std::cout << "n/a\n";
+    std::cout << "pipelined vs I/O only    : " << 100.0 * raw.secs / piped.secs << " %\n"
+              << std::defaultfloat;
+    return 0;
+}
+
+#endif // SAXPY_HAVE_POSIX_IO
+
 // -----------------------------------------------------------------------------
 //  Main driver
 // -----------------------------------------------------------------------------
-int main()
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::strcmp(argv[1], "stream") == 0) {
+#if defined(SAXPY_HAVE_POSIX_IO)
+        return stream_main(argc, argv);
+#else
+        std::cerr << "stream mode needs POSIX I/O (pread, mmap)\n";
+        return 1;
+#endif
+    }
+
     constexpr std::size_t N = 1u << 24;            // 16 M elements (~64 MiB I/O)
 
     std::vector<float> a(N), b(N), out1(N), out2(N);
@@ -74,4 +909,25 @@ int main()
 
     // print one value so nothing is optimised away
     std::cout << "sample out = " << out1[N / 2] << '\n';
+
+    // -------------------------------------------------------------------------
+    //  Storage formats: float32 vs bf16 / fp16 / int8 inputs, float output.
+    //  Errors are measured against the float32 fma result (out2).
+    // -------------------------------------------------------------------------
+    std::cout << "\nstorage formats (best of 5, widen path: "
+              << widen_path_name(widen_path) << ", picked at run time)\n";
+
+    const auto a_bf = encode_bf16(a), b_bf = encode_bf16(b);
+    const auto a_hf = encode_fp16(a), b_hf = encode_fp16(b);
+    const auto a_i8 = encode_i8(a),   b_i8 = encode_i8(b);
+    std::vector<float> out3(N);
+
+    time_bw([&]{ saxpy_f32(a.data(), b.data(), out3.data(), N); },
+            "f32", N, 3 * sizeof(float), out3, out2);
+    time_bw([&]{ saxpy_bf16(a_bf.q.data(), a_bf.scale, b_bf.q.data(), b_bf.scale, out3.data(), N); },
+            "bf16", N, 2 * sizeof(std::uint16_t) + sizeof(float), out3, out2);
+    time_bw([&]{ saxpy_fp16(a_hf.q.data(), a_hf.scale, b_hf.q.data(), b_hf.scale, out3.data(), N); },
+            "fp16", N, 2 * sizeof(std::uint16_t) + sizeof(float), out3, out2);
+    time_bw([&]{ saxpy_i8(a_i8.q.data(), a_i8.scale, b_i8.q.data(), b_i8.scale, out3.data(), N); },
+            "int8", N, 2 * sizeof(std::int8_t) + sizeof(float), out3, out2);
 }
\ No newline at end of file
@@ -0,0 +1,354 @@
+/*  specialization_bench
+ *
+ *  Goal: compare kernels whose parameters are compile-time constants
+ *        (template arguments) with the same kernels taking runtime
+ *        parameters, route common runtime values to pre-instantiated
+ *        specializations, and measure what each instantiation costs
+ *        in binary size.
+ *
+ *  The three kernels mirror the rest of the repo:
+ *      saxpy  – constexpr coefficients   (algebraic_reductions_vectorization)
+ *      copy   – trip count baked in      (loop_unrolling, copy_unrolled<K>)
+ *      scale  – x * factor + 1           (devirtualization, Derived::foo)
+ *
+ *  Build (one binary per N_SPECS value, see CMakeLists.txt):
+ *      cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+ *      cmake --build build -j
+ *
+ *  Run:
+ *      ./build/spec_8
+ *
+ *  Code size per kernel comes from nm, see code_size.cmake.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef N_SPECS
+#   define N_SPECS 8          // pre-instantiated specializations per kernel
+#endif
+#ifndef ITERS
+#   define ITERS 2000         // calls per timed batch
+#endif
+
+// Kernel entry points are NO_INLINE so repeated calls in a timing loop
+// cannot be merged or hoisted by the optimiser.  The _ct kernels are
+// ALWAYS_INLINE: the dispatcher and the direct-call entry points each get
+// their own copy, so no symbol is shared between them (even at -O0) and
+// code_size.cmake charges every specialization to its dispatcher.
+#if defined(_MSC_VER)
+#   define NO_INLINE     __declspec(noinline)
+#   define ALWAYS_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#   define NO_INLINE     __attribute__((noinline))
+#   define ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#   define NO_INLINE
+#   define ALWAYS_INLINE inline
+#endif
+
+volatile std::uint64_t sink = 0;   // keeps results alive
+
+/* ------------------------------------------------------------------ */
+/* 1. Kernels – compile-time (_ct) and runtime (_rt) forms             */
+/* ------------------------------------------------------------------ */
+template <int C1, int C2, int C3>
+ALWAYS_INLINE void saxpy_ct(const float* __restrict a, const float* __restrict b,
+              float* __restrict out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = a[i] * float(C1) + b[i] * float(C2) + float(C3);
+}
+
+NO_INLINE void saxpy_rt(const float* __restrict a, const float* __restrict b,
+                        float* __restrict out, std::size_t n,
+                        float c1, float c2, float c3)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = a[i] * c1 + b[i] * c2 + c3;
+}
+
+template <std::size_t N>
+ALWAYS_INLINE void copy_ct(const int* __restrict src, int* __restrict dst)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        dst[i] = src[i];
+}
+
+NO_INLINE void copy_rt(const int* __restrict src, int* __restrict dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] = src[i];
+}
+
+template <std::uint64_t F>
+ALWAYS_INLINE std::uint64_t scale_ct(const std::uint64_t* x, std::size_t n)
+{
+    std::uint64_t s = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        s += x[i] * F + 1;
+    return s;
+}
+
+NO_INLINE std::uint64_t scale_rt(const std::uint64_t* x, std::size_t n, std::uint64_t f)
+{
+    std::uint64_t s = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        s += x[i] * f + 1;
+    return s;
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Specialization tables – the first N_SPECS entries get            */
+/*    instantiated; entry 0 is the value the benchmark uses            */
+/* ------------------------------------------------------------------ */
+struct SaxpyParams { int c1, c2, c3; };
+
+constexpr std::array<SaxpyParams, 8> SAXPY_SPECS {{
+    {2, 3, -10}, {1, 1, 0}, {2, 0, 0}, {1, -1, 0},
+    {4, 4, 1},   {3, 5, -7}, {8, 1, 0}, {-1, 2, 3},
+}};
+constexpr std::array<std::size_t, 8>   COPY_SPECS  { 1024, 256, 4096, 64, 16384, 100, 1000, 65536 };
+constexpr std::array<std::uint64_t, 8> SCALE_SPECS { 2, 3, 10, 16, 7, 100, 1000, 1 };
+
+static_assert(N_SPECS >= 0 && N_SPECS <= 8, "N_SPECS must be in [0, 8]");
+
+// In no table: the dispatcher compares against all N_SPECS entries, then falls back.
+constexpr SaxpyParams   SAXPY_MISS {5, 5, 5};
+constexpr std::size_t   COPY_MISS  = 512;
+constexpr std::uint64_t SCALE_MISS = 5;
+
+/* ------------------------------------------------------------------ */
+/* 3. Runtime dispatchers: linear scan over the table, fall back to    */
+/*    the generic kernel on a miss                                     */
+/* ------------------------------------------------------------------ */
+template <std::size_t... I>
+void saxpy_dispatch_impl(std::index_sequence<I...>,
+                         const float* a, const float* b, float* out, std::size_t n,
+                         float c1, float c2, float c3)
+{
+    const bool hit = ((c1 == float(SAXPY_SPECS[I].c1) &&
+                       c2 == float(SAXPY_SPECS[I].c2) &&
+                       c3 == float(SAXPY_SPECS[I].c3) &&
+                       (saxpy_ct<SAXPY_SPECS[I].c1, SAXPY_SPECS[I].c2, SAXPY_SPECS[I].c3>(a, b, out, n),
+                        true)) || ...);
+    if (!hit) saxpy_rt(a, b, out, n, c1, c2, c3);
+}
+
+NO_INLINE void saxpy_dispatch(const float* a, const float* b, float* out, std::size_t n,
+                              float c1, float c2, float c3)
+{
+    saxpy_dispatch_impl(std::make_index_sequence<N_SPECS>{}, a, b, out, n, c1, c2, c3);
+}
+
+template <std::size_t... I>
+void copy_dispatch_impl(std::index_sequence<I...>, const int* src, int* dst, std::size_t n)
+{
+    const bool hit = ((n == COPY_SPECS[I] && (copy_ct<COPY_SPECS[I]>(src, dst), true)) || ...);
+    if (!hit) copy_rt(src, dst, n);
+}
+
+NO_INLINE void copy_dispatch(const int* src, int* dst, std::size_t n)
+{
+    copy_dispatch_impl(std::make_index_sequence<N_SPECS>{}, src, dst, n);
+}
+
+template <std::size_t... I>
+std::uint64_t scale_dispatch_impl(std::index_sequence<I...>,
+                                  const std::uint64_t* x, std::size_t n, std::uint64_t f)
+{
+    std::uint64_t s = 0;
+    const bool hit = ((f == SCALE_SPECS[I] && (s = scale_ct<SCALE_SPECS[I]>(x, n), true)) || ...);
+    return hit ? s : scale_rt(x, n, f);
+}
+
+NO_INLINE std::uint64_t scale_dispatch(const std::uint64_t* x, std::size_t n, std::uint64_t f)
+{
+    return scale_dispatch_impl(std::make_index_sequence<N_SPECS>{}, x, n, f);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Direct calls of table entry I – the specialization without the   */
+/*    dispatcher in front of it                                        */
+/* ------------------------------------------------------------------ */
+template <std::size_t I>
+NO_INLINE void saxpy_direct(const float* a, const float* b, float* out, std::size_t n)
+{
+    saxpy_ct<SAXPY_SPECS[I].c1, SAXPY_SPECS[I].c2, SAXPY_SPECS[I].c3>(a, b, out, n);
+}
+
+template <std::size_t I>
+NO_INLINE void copy_direct(const int* src, int* dst)
+{
+    copy_ct<COPY_SPECS[I]>(src, dst);
+}
+
+template <std::size_t I>
+NO_INLINE std::uint64_t scale_direct(const std::uint64_t* x, std::size_t n)
+{
+    return scale_ct<SCALE_SPECS[I]>(x, n);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Timing helpers: best of 5 batches, ns per call                   */
+/* ------------------------------------------------------------------ */
+template <typename F>
+double ns_per_call(F&& f)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < 5; ++r) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERS; ++i) f();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERS);
+    }
+    return best;
+}
+
+// Reads a parameter back through a volatile so the optimiser cannot
+// constant-propagate it into the "runtime" kernels.
+template <typename T>
+T opaque(T v)
+{
+    volatile T x = v;
+    return x;
+}
+
+// t_ct < 0: no specialization to call directly (a miss)
+void print_row(const std::string& kernel, const std::string& which, const std::string& params,
+               double t_rt, double t_ct, double t_disp)
+{
+    std::cout << std::left  << std::setw(8)  << kernel << std::setw(7) << which
+              << std::setw(18) << params
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << t_rt;
+    if (t_ct < 0) std::cout << std::setw(14) << "-";
+    else          std::cout << std::setw(14) << t_ct;
+    std::cout << std::setw(16) << t_disp
+              << std::setprecision(2)
+              << std::setw(10) << t_rt / t_disp << "x\n";
+}
+
+/* ------------------------------------------------------------------ */
+/* 6. Code size: per-kernel bytes written by code_size.cmake after     */
+/*    the build, in codesize/spec_<k>.txt next to the binary           */
+/* ------------------------------------------------------------------ */
+constexpr std::array<const char*, 3> KERNELS { "saxpy", "copy", "scale" };
+
+bool read_code_size(const std::filesystem::path& file, std::array<long long, 3>& bytes)
+{
+    std::ifstream in(file);
+    std::string   kernel;
+    long long     n     = 0;
+    std::size_t   found = 0;
+    while (in >> kernel >> n)
+        for (std::size_t k = 0; k < KERNELS.size(); ++k)
+            if (kernel == KERNELS[k]) { bytes[k] = n; ++found; }
+    return found == KERNELS.size();
+}
+
+void print_code_size(const std::filesystem::path& dir)
+{
+    std::array<long long, 3> size {}, base {};
+    std::cout << "\nCode size (nm: specializations + dispatcher)";
+    if (!read_code_size(dir / "codesize" / ("spec_" + std::to_string(N_SPECS) + ".txt"), size)) {
+        std::cout << ": n/a (no nm at build time)\n";
+        return;
+    }
+    std::cout << '\n';
+    const bool have_base = read_code_size(dir / "codesize" / "spec_0.txt", base);
+    for (std::size_t k = 0; k < KERNELS.size(); ++k) {
+        std::cout << std::left << std::setw(8) << KERNELS[k]
+                  << std::right << std::setw(8) << size[k] << " bytes";
+        if constexpr (N_SPECS > 0) {
+            if (have_base) {
+                const long long delta = size[k] - base[k];
+                std::cout << "  (" << std::showpos << delta << std::noshowpos << " vs spec_0, "
+                          << delta / N_SPECS << " per specialization)";
+            }
+        }
+        std::cout << '\n';
+    }
+}
+
+/* ------------------------------------------------------------------ */
+int main(int, char* argv[])
+{
+    constexpr std::size_t N    = 1u << 11;               // 8–16 KiB per buffer: stays in L1
+    constexpr std::size_t LAST = SAXPY_SPECS.size() - 1;  // a late hit in spec_8, a miss below
+
+    const std::size_t copy_max = std::max({COPY_SPECS[0], COPY_SPECS[LAST], COPY_MISS});
+    std::vector<float> a(N), b(N), out(N);
+    std::vector<int>   src(copy_max), dst(copy_max);
+    std::vector<std::uint64_t> x(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        a[i] = 0.1f * float(i);
+        b[i] = 0.2f * float(i);
+        x[i] = i;
+    }
+    for (std::size_t i = 0; i < copy_max; ++i) src[i] = int(i);
+
+    std::cout << "Specializations per kernel: " << N_SPECS
+              << (N_SPECS == 0 ? "  (dispatcher always falls back to the generic kernel)" : "")
+              << "\n\n"
+              << std::left  << std::setw(8) << "Kernel" << std::setw(7) << "Case"
+              << std::setw(18) << "Params"
+              << std::right << std::setw(14) << "Generic (ns)" << std::setw(14) << "Direct (ns)"
+              << std::setw(16) << "Dispatched (ns)" << std::setw(11) << "Speedup" << '\n'
+              << std::string(88, '-') << '\n';
+
+    // first: table entry 0, found by the first compare
+    // last : table entry 7, found by the last compare in spec_8 (a miss with fewer specs)
+    // miss : in no table, every compare fails before the generic fallback
+    using SaxpyFn = void (*)(const float*, const float*, float*, std::size_t);
+    auto saxpy_row = [&](const char* which, SaxpyParams p, SaxpyFn direct) {
+        const float c1 = float(opaque(p.c1)), c2 = float(opaque(p.c2)), c3 = float(opaque(p.c3));
+        const double t_rt = ns_per_call([&] { saxpy_rt(a.data(), b.data(), out.data(), N, c1, c2, c3); });
+        const double t_ct = direct ? ns_per_call([&] { direct(a.data(), b.data(), out.data(), N); }) : -1.0;
+        const double t_d  = ns_per_call([&] { saxpy_dispatch(a.data(), b.data(), out.data(), N, c1, c2, c3); });
+        sink = sink + static_cast<std::uint64_t>(out[N / 2]);
+        print_row("saxpy", which, std::to_string(p.c1) + "," + std::to_string(p.c2) + "," +
+                  std::to_string(p.c3) + "  n=" + std::to_string(N), t_rt, t_ct, t_d);
+    };
+    saxpy_row("first", SAXPY_SPECS[0],    &saxpy_direct<0>);
+    saxpy_row("last",  SAXPY_SPECS[LAST], &saxpy_direct<LAST>);
+    saxpy_row("miss",  SAXPY_MISS,        nullptr);
+
+    using CopyFn = void (*)(const int*, int*);
+    auto copy_row = [&](const char* which, std::size_t n, CopyFn direct) {
+        const std::size_t copy_n = opaque(n);
+        const double t_rt = ns_per_call([&] { copy_rt(src.data(), dst.data(), copy_n); });
+        const double t_ct = direct ? ns_per_call([&] { direct(src.data(), dst.data()); }) : -1.0;
+        const double t_d  = ns_per_call([&] { copy_dispatch(src.data(), dst.data(), copy_n); });
+        sink = sink + static_cast<std::uint64_t>(dst[copy_n / 2]);
+        print_row("copy", which, "n=" + std::to_string(copy_n), t_rt, t_ct, t_d);
+    };
+    copy_row("first", COPY_SPECS[0],    &copy_direct<0>);
+    copy_row("last",  COPY_SPECS[LAST], &copy_direct<LAST>);
+    copy_row("miss",  COPY_MISS,        nullptr);
+
+    using ScaleFn = std::uint64_t (*)(const std::uint64_t*, std::size_t);
+    auto scale_row = [&](const char* which, std::uint64_t f, ScaleFn direct) {
+        const std::uint64_t factor = opaque(f);
+        const double t_rt = ns_per_call([&] { sink = sink + scale_rt(x.data(), N, factor); });
+        const double t_ct = direct ? ns_per_call([&] { sink = sink + direct(x.data(), N); }) : -1.0;
+        const double t_d  = ns_per_call([&] { sink = sink + scale_dispatch(x.data(), N, factor); });
+        print_row("scale", which, "f=" + std::to_string(factor) + "  n=" + std::to_string(N),
+                  t_rt, t_ct, t_d);
+    };
+    scale_row("first", SCALE_SPECS[0],    &scale_direct<0>);
+    scale_row("last",  SCALE_SPECS[LAST], &scale_direct<LAST>);
+    scale_row("miss",  SCALE_MISS,        nullptr);
+
+    print_code_size(std::filesystem::path(argv[0]).parent_path());
+}
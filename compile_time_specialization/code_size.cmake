@@ -0,0 +1,34 @@
+# Post-build step: code bytes each kernel contributes to a spec_<k> binary.
+#
+#   cmake -DNM=<nm> -DEXE=<binary> -DOUT=<file> -P code_size.cmake
+#
+# Sums the nm symbol sizes of every <kernel>_ct instantiation, the
+# <kernel>_dispatch_impl<...> fold and <kernel>_dispatch itself, including
+# compiler clones such as `.constprop` - whichever of them survive depends on
+# how much the optimiser inlined - and writes one "<kernel> <bytes>" line per
+# kernel.  Unlike the file size this does not move in page-sized steps.
+#
+# `nm -C` prints the return type in front of demangled template names
+# ("W void copy_ct<100ul>(int const*, int*)"), hence the optional prefix.
+execute_process(
+    COMMAND "${NM}" -C -S --defined-only "${EXE}"
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE rc)
+if(NOT rc EQUAL 0)
+    message(WARNING "code_size: ${NM} failed on ${EXE}")
+    return()
+endif()
+
+set(report "")
+foreach(kernel saxpy copy scale)
+    string(REGEX MATCHALL
+           "[0-9a-fA-F]+ [0-9a-fA-F]+ [tTwW] ([^\n]* )?${kernel}_(ct<|dispatch_impl<|dispatch\\()"
+           hits "${symbols}")
+    set(total 0)
+    foreach(hit ${hits})
+        string(REGEX REPLACE "^[0-9a-fA-F]+ ([0-9a-fA-F]+) .*" "\\1" size "${hit}")
+        math(EXPR total "${total} + 0x${size}")
+    endforeach()
+    string(APPEND report "${kernel} ${total}\n")
+endforeach()
+file(WRITE "${OUT}" "${report}")
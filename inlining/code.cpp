@@ -5,7 +5,12 @@
 #include <string>
 #include <cstdlib>
 
-// use -DFORCE_INLINE or -DNO_INLINE during compilation
+// use -DSHM_METRICS (CMake option) to stream every sample to shm_reader
+#if defined(SHM_METRICS)
+    #include "shm_ring.hpp"
+#endif
+
+// use -DFORCE_INLINE_MODE or -DNO_INLINE_MODE during compilation
 #if defined(_MSC_VER)
     #define ALWAYS_INLINE __forceinline
     #define NO_INLINE __declspec(noinline)
@@ -62,11 +67,29 @@ int main(int argc, char* argv[]) {
     vector<double> durations;
     durations.reserve(repeats);
 
+    // detect optimization type from macros
+    // (the *_MODE macros: NO_INLINE itself is always defined above)
+    #if defined(FORCE_INLINE_MODE)
+        string mode = "forced_inline";
+    #elif defined(NO_INLINE_MODE)
+        string mode = "no_inline";
+    #else
+        string mode = "default_inline";
+    #endif
+
+#if defined(SHM_METRICS)
+    shm_metrics::Producer metrics;
+    const auto kernel_id = metrics.kernel(("inlining/" + mode).c_str());
+#endif
+
     for (int i = 0; i < repeats; ++i) {
         auto start = high_resolution_clock::now();
         volatile int result = compute(n);  // volatile to prevent optimization-out
         auto end = high_resolution_clock::now();
         durations.push_back(duration<double>(end - start).count());
+#if defined(SHM_METRICS)
+        metrics.publish(kernel_id, {n}, duration_cast<nanoseconds>(end - start).count());
+#endif
     }
 
     ofstream out(output_file, ios::app);
@@ -75,17 +98,8 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // detect optimization type from macros
-    #if defined(FORCE_INLINE)
-        string mode = "forced_inline";
-    #elif defined(NO_INLINE)
-        string mode = "no_inline";
-    #else
-        string mode = "default_inline";
-    #endif
-
     for (int i = 0; i < repeats; ++i) {
-        out << mode << "," << n << "," << durations[i] << endl;
+        out << mode << "," << n << "," << durations[i] << '\n';   // one flush at close
     }
 
     cout << "Benchmark completed. Results written to " << output_file << endl;
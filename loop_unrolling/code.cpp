@@ -4,6 +4,10 @@
 #include <random>
 #include <fstream>
 
+#if defined(SHM_METRICS)                 // -DSHM_METRICS=ON, see ../shm_metrics
+#   include "shm_ring.hpp"
+#endif
+
 #ifndef UF
 #   define UF 1
 #endif
@@ -48,9 +52,19 @@ int main() {
     std::uniform_int_distribution<int> dist(1, 100);
     for (auto& x : src) x = dist(rng);
 
+#if defined(SHM_METRICS)
+    shm_metrics::Producer metrics;
+    const auto kernel_id = metrics.kernel(SHM_KERNEL_NAME);
+#endif
+
     uint64_t total = 0;
-    for (int i = 0; i < ITERS; ++i)
-        total += time_once<UF>(src, dst);
+    for (int i = 0; i < ITERS; ++i) {
+        const uint64_t ns = time_once<UF>(src, dst);
+        total += ns;
+#if defined(SHM_METRICS)
+        metrics.publish(kernel_id, {UF, static_cast<std::int64_t>(SIZE)}, ns);
+#endif
+    }
 
     double avg = static_cast<double>(total) / ITERS;
 
@@ -0,0 +1,216 @@
+/*  shm_reader – tail the shared-memory metrics ring
+ *
+ *  Attaches read-only to the segment written by shm_metrics::Producer,
+ *  follows new samples as they are published and prints a per-kernel
+ *  summary every interval.  Optionally writes every sample as CSV or as
+ *  raw 56-byte records, and the final summary as CSV.
+ *
+ *  Run:
+ *      ./shm_reader                                  # live summary on stdout
+ *      ./shm_reader --csv sweep.csv --idle 30        # log, stop after 30 s of silence
+ *      ./shm_reader --bin sweep.bin --summary sum.csv
+ *      ./shm_reader --unlink                         # remove the segment
+ */
+
+#include "shm_ring.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+volatile std::sig_atomic_t stop = 0;
+
+struct Key {
+    std::uint32_t kernel;
+    std::uint32_t n_params;
+    std::int64_t  params[3];
+
+    bool operator<(const Key& o) const
+    {
+        return std::tie(kernel, n_params, params[0], params[1], params[2]) <
+               std::tie(o.kernel, o.n_params, o.params[0], o.params[1], o.params[2]);
+    }
+};
+
+struct Stats {
+    std::uint64_t count = 0;
+    double        sum   = 0.0;
+    std::uint64_t min   = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max   = 0;
+    std::uint64_t last  = 0;
+
+    void add(std::uint64_t ns)
+    {
+        ++count;
+        sum += double(ns);
+        min  = std::min(min, ns);
+        max  = std::max(max, ns);
+        last = ns;
+    }
+};
+
+std::string label(const shm_metrics::Reader& r, const Key& k)
+{
+    std::string s = r.kernel_name(k.kernel);
+    s += '(';
+    for (std::uint32_t i = 0; i < k.n_params; ++i) {
+        if (i) s += ',';
+        s += std::to_string(k.params[i]);
+    }
+    return s + ')';
+}
+
+void print_summary(std::ostream& os, const shm_metrics::Reader& r,
+                   const std::map<Key, Stats>& stats, std::uint64_t seen, std::uint64_t dropped)
+{
+    os << "\nsamples " << seen << "   dropped " << dropped << '\n'
+       << std::left  << std::setw(36) << "Kernel(params)"
+       << std::right << std::setw(10) << "Count"
+       << std::setw(14) << "Mean (ns)" << std::setw(14) << "Min (ns)"
+       << std::setw(14) << "Max (ns)"  << std::setw(14) << "Last (ns)" << '\n'
+       << std::string(102, '-') << '\n';
+    for (const auto& [k, s] : stats)
+        os << std::left  << std::setw(36) << label(r, k)
+           << std::right << std::setw(10) << s.count
+           << std::fixed << std::setprecision(0)
+           << std::setw(14) << s.sum / double(s.count)
+           << std::setw(14) << s.min << std::setw(14) << s.max << std::setw(14) << s.last << '\n';
+    os << std::flush;
+}
+
+void write_summary_csv(const std::string& path, const shm_metrics::Reader& r,
+                       const std::map<Key, Stats>& stats)
+{
+    std::ofstream out(path);
+    out << "kernel,p0,p1,p2,count,mean_ns,min_ns,max_ns\n";
+    for (const auto& [k, s] : stats)
+        out << r.kernel_name(k.kernel) << ',' << k.params[0] << ',' << k.params[1] << ','
+            << k.params[2] << ',' << s.count << ',' << s.sum / double(s.count) << ','
+            << s.min << ',' << s.max << '\n';
+}
+
+void usage(const char* exe)
+{
+    std::cerr << "usage: " << exe << " [--name /seg] [--csv FILE] [--bin FILE] [--summary FILE]\n"
+              << "       [--interval SEC] [--idle SEC] [--from-start] [--unlink]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string name = shm_metrics::DEFAULT_NAME;
+    std::string csv_path, bin_path, summary_path;
+    double      interval   = 2.0;      // seconds between live summaries
+    double      idle_limit = 0.0;      // 0 = run until Ctrl-C
+    bool        from_start = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_val = i + 1 < argc;
+        if      (arg == "--name"     && has_val) name         = argv[++i];
+        else if (arg == "--csv"      && has_val) csv_path     = argv[++i];
+        else if (arg == "--bin"      && has_val) bin_path     = argv[++i];
+        else if (arg == "--summary"  && has_val) summary_path = argv[++i];
+        else if (arg == "--interval" && has_val) interval     = std::atof(argv[++i]);
+        else if (arg == "--idle"     && has_val) idle_limit   = std::atof(argv[++i]);
+        else if (arg == "--from-start")          from_start   = true;
+        else if (arg == "--unlink") {
+            if (::shm_unlink(name.c_str()) != 0) {
+                std::cerr << "shm_unlink(" << name << "): " << std::strerror(errno) << '\n';
+                return 1;
+            }
+            return 0;
+        }
+        else { usage(argv[0]); return 1; }
+    }
+
+    std::signal(SIGINT,  [](int) { stop = 1; });
+    std::signal(SIGTERM, [](int) { stop = 1; });
+
+    using clock = std::chrono::steady_clock;
+    const auto poll = std::chrono::milliseconds(10);
+
+    // Wait for the first producer to create the segment.  Everything in a
+    // segment that appeared while we waited is new, so replay it.
+    std::unique_ptr<shm_metrics::Reader> reader;
+    const auto t_start = clock::now();
+    while (!stop) {
+        reader = std::make_unique<shm_metrics::Reader>(name.c_str());
+        if (reader->ok()) break;
+        from_start = true;
+        if (idle_limit > 0 &&
+            std::chrono::duration<double>(clock::now() - t_start).count() > idle_limit) {
+            std::cerr << "no segment " << name << " after " << idle_limit << " s\n";
+            return 1;
+        }
+        std::this_thread::sleep_for(poll);
+    }
+    if (stop) return 0;
+
+    std::ofstream csv, bin;
+    if (!csv_path.empty()) {
+        csv.open(csv_path);
+        csv << "seq,kernel,p0,p1,p2,ns,c0,c1\n";
+    }
+    if (!bin_path.empty())
+        bin.open(bin_path, std::ios::binary);
+
+    const std::uint64_t cap = reader->capacity();
+    std::uint64_t next = reader->head();
+    if (from_start) next = next > cap ? next - cap : 0;
+
+    std::map<Key, Stats> stats;
+    std::uint64_t seen = 0, dropped = 0;
+    auto last_sample  = clock::now();
+    auto last_summary = clock::now();
+
+    while (!stop) {
+        const std::uint64_t head = reader->head();
+        if (head < next) next = head;                 // segment was reset underneath us
+        if (head - next > cap) {                      // lapped: the oldest are gone
+            dropped += head - cap - next;
+            next     = head - cap;
+        }
+
+        for (; next < head; ++next) {
+            shm_metrics::Sample s;
+            if (!reader->read(next, s)) { ++dropped; continue; }
+            ++seen;
+            stats[Key{s.kernel, s.n_params, {s.params[0], s.params[1], s.params[2]}}].add(s.ns);
+            if (csv.is_open())
+                csv << next << ',' << reader->kernel_name(s.kernel) << ',' << s.params[0] << ','
+                    << s.params[1] << ',' << s.params[2] << ',' << s.ns << ','
+                    << s.counters[0] << ',' << s.counters[1] << '\n';
+            if (bin.is_open())
+                bin.write(reinterpret_cast<const char*>(&s), sizeof s);
+            last_sample = clock::now();
+        }
+
+        const auto now = clock::now();
+        if (std::chrono::duration<double>(now - last_summary).count() >= interval) {
+            print_summary(std::cout, *reader, stats, seen, dropped);
+            last_summary = now;
+        }
+        if (idle_limit > 0 && std::chrono::duration<double>(now - last_sample).count() > idle_limit)
+            break;
+        if (reader->head() == next)
+            std::this_thread::sleep_for(poll);
+    }
+
+    print_summary(std::cout, *reader, stats, seen, dropped);
+    if (!summary_path.empty())
+        write_summary_csv(summary_path, *reader, stats);
+    return 0;
+}
@@ -0,0 +1,24 @@
+# Shared-memory metrics ring – opt-in hook for the benchmark projects.
+#
+#   include(${CMAKE_CURRENT_SOURCE_DIR}/../shm_metrics/shm_metrics.cmake)
+#   shm_metrics_enable(<target>)
+#
+# Defines SHM_METRICS, adds shm_ring.hpp to the include path and links
+# librt where shm_open lives there (glibc < 2.34).
+
+set(SHM_METRICS_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+function(shm_metrics_enable target)
+    if (WIN32)
+        message(WARNING "SHM_METRICS needs POSIX shared memory – ignored for ${target}")
+        return()
+    endif()
+
+    target_compile_definitions(${target} PRIVATE SHM_METRICS)
+    target_include_directories(${target} PRIVATE ${SHM_METRICS_DIR})
+
+    find_library(SHM_METRICS_RT rt)
+    if (SHM_METRICS_RT)
+        target_link_libraries(${target} PRIVATE ${SHM_METRICS_RT})
+    endif()
+endfunction()
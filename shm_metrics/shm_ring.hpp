@@ -0,0 +1,291 @@
+/*  shm_ring.hpp – lock-free single-producer metrics ring in POSIX shared memory
+ *
+ *  A benchmark publishes one 64-byte record per timed sample (kernel id,
+ *  up to three integer parameters, nanoseconds, two free counters);
+ *  `shm_reader` maps the same segment read-only and tails it live.
+ *
+ *  After construction the producer never blocks and never makes a
+ *  syscall: publish() is seven relaxed stores plus two release stores.
+ *  The segment is prefaulted when it is mapped, so the first lap does
+ *  not take page faults either.
+ *  If the reader falls more than `capacity` samples behind, the oldest
+ *  slots are overwritten and the reader counts them as dropped – the
+ *  benchmark is never slowed down by a slow or missing reader.
+ *
+ *  Segment layout (default name /optimizations_metrics → /dev/shm/…):
+ *      Header          magic, capacity, kernel-name table, head counter
+ *      Slot[capacity]  per-slot sequence word (seqlock) + 7 payload words
+ *
+ *  Only one producer may write at a time.  Consecutive producers (e.g.
+ *  every binary of a sweep) reuse the segment and continue the sequence,
+ *  so one reader can follow the whole sweep.
+ */
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shm_metrics {
+
+constexpr std::uint64_t MAGIC            = 0x31474E49524D4853ull;   // "SHMRING1"
+constexpr std::uint32_t VERSION          = 1;
+constexpr std::uint32_t DEFAULT_CAPACITY = 1u << 16;                // 4 MiB of slots
+constexpr std::uint32_t MAX_KERNELS      = 64;
+constexpr std::uint32_t OVERFLOW_KERNEL  = MAX_KERNELS;            // id once the name table is full
+constexpr std::size_t   NAME_LEN         = 48;
+constexpr const char*   DEFAULT_NAME     = "/optimizations_metrics";
+
+// One timed sample – exactly seven 64-bit words.
+struct Sample {
+    std::uint32_t kernel   = 0;          // index into Header::names, or OVERFLOW_KERNEL
+    std::uint32_t n_params = 0;          // how many of params[] are used
+    std::int64_t  params[3] {};
+    std::uint64_t ns       = 0;
+    std::uint64_t counters[2] {};        // free for the producer (e.g. perf deltas)
+};
+static_assert(sizeof(Sample) == 7 * sizeof(std::uint64_t), "Sample must be 7 words");
+
+struct alignas(64) Slot {
+    std::atomic<std::uint64_t> seq;      // 2*i+1 while writing sample i, 2*i+2 once published
+    std::atomic<std::uint64_t> words[7];
+};
+static_assert(sizeof(Slot) == 64, "Slot must fill one cache line");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared-memory atomics must be lock-free");
+
+struct Header {
+    std::atomic<std::uint64_t> magic;    // written last by the creator
+    std::uint32_t              version;
+    std::uint32_t              capacity; // power of two
+    std::atomic<std::uint32_t> n_kernels;
+    char                       names[MAX_KERNELS][NAME_LEN];
+    alignas(64) std::atomic<std::uint64_t> head;   // samples published so far
+};
+
+inline std::size_t segment_bytes(std::uint32_t capacity)
+{
+    return sizeof(Header) + std::size_t(capacity) * sizeof(Slot);
+}
+
+inline Slot* slots_of(Header* h) { return reinterpret_cast<Slot*>(h + 1); }
+
+/* ------------------------------------------------------------------ */
+/* Producer – lives inside the benchmark                               */
+/* ------------------------------------------------------------------ */
+class Producer {
+public:
+    explicit Producer(const char* name = DEFAULT_NAME, std::uint32_t capacity = DEFAULT_CAPACITY)
+    {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            std::cerr << "shm_metrics: capacity must be a power of two\n";
+            return;
+        }
+        int fd = ::shm_open(name, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            std::cerr << "shm_metrics: shm_open(" << name << "): " << std::strerror(errno) << '\n';
+            return;
+        }
+
+        // Reuse an existing segment (and its capacity) so a sweep keeps one sequence.
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > static_cast<off_t>(sizeof(Header)))
+            capacity = static_cast<std::uint32_t>((st.st_size - sizeof(Header)) / sizeof(Slot));
+        else if (::ftruncate(fd, static_cast<off_t>(segment_bytes(capacity))) != 0) {
+            std::cerr << "shm_metrics: ftruncate: " << std::strerror(errno) << '\n';
+            ::close(fd);
+            return;
+        }
+
+        bytes_  = segment_bytes(capacity);
+#if defined(MAP_POPULATE)
+        const int flags = MAP_SHARED | MAP_POPULATE;    // prefault: publish() never page-faults
+#else
+        const int flags = MAP_SHARED;
+#endif
+        void* p = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, flags, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            std::cerr << "shm_metrics: mmap: " << std::strerror(errno) << '\n';
+            return;
+        }
+
+        hdr_ = static_cast<Header*>(p);
+        if (hdr_->magic.load(std::memory_order_acquire) != MAGIC) {
+            hdr_->version  = VERSION;
+            hdr_->capacity = capacity;
+            hdr_->n_kernels.store(0, std::memory_order_relaxed);
+            hdr_->head.store(0, std::memory_order_relaxed);
+            hdr_->magic.store(MAGIC, std::memory_order_release);
+        } else if (hdr_->version != VERSION || hdr_->capacity != capacity) {
+            std::cerr << "shm_metrics: " << name << " has an incompatible layout; "
+                         "remove it with `shm_reader --unlink`\n";
+            ::munmap(p, bytes_);
+            hdr_ = nullptr;
+            return;
+        }
+
+        slots_ = slots_of(hdr_);
+        mask_  = capacity - 1;
+        head_  = hdr_->head.load(std::memory_order_relaxed);
+
+#if !defined(MAP_POPULATE)
+        // No MAP_POPULATE (macOS): touch one slot per page.  A no-op RMW
+        // faults the page in writable without disturbing a live sequence.
+        const std::size_t per_page = std::size_t(::sysconf(_SC_PAGESIZE)) / sizeof(Slot);
+        for (std::size_t i = 0; i < capacity; i += per_page ? per_page : 1)
+            slots_[i].seq.fetch_add(0, std::memory_order_relaxed);
+#endif
+    }
+
+    // The segment outlives the producer so the reader can drain it.
+    ~Producer()
+    {
+        if (hdr_) ::munmap(hdr_, bytes_);
+    }
+
+    Producer(const Producer&)            = delete;
+    Producer& operator=(const Producer&) = delete;
+
+    bool ok() const { return hdr_ != nullptr; }
+
+    // Look up or register a kernel name and return its id.  Call once per
+    // kernel, outside the timed region.  Once the table is full new names
+    // get OVERFLOW_KERNEL, which the reader shows as "(overflow)".
+    std::uint32_t kernel(const char* name)
+    {
+        if (!hdr_) return OVERFLOW_KERNEL;
+        const std::uint32_t n = hdr_->n_kernels.load(std::memory_order_acquire);
+        for (std::uint32_t i = 0; i < n; ++i)
+            if (std::strncmp(hdr_->names[i], name, NAME_LEN - 1) == 0) return i;
+        if (n == MAX_KERNELS) {
+            std::cerr << "shm_metrics: kernel table full, '" << name << "' logged as (overflow)\n";
+            return OVERFLOW_KERNEL;
+        }
+        std::strncpy(hdr_->names[n], name, NAME_LEN - 1);
+        hdr_->names[n][NAME_LEN - 1] = '\0';
+        hdr_->n_kernels.store(n + 1, std::memory_order_release);
+        return n;
+    }
+
+    void publish(const Sample& s) noexcept
+    {
+        if (!hdr_) return;
+
+        std::uint64_t w[7];
+        std::memcpy(w, &s, sizeof w);
+
+        Slot& slot = slots_[head_ & mask_];
+        slot.seq.store(2 * head_ + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < 7; ++i)
+            slot.words[i].store(w[i], std::memory_order_relaxed);
+        slot.seq.store(2 * head_ + 2, std::memory_order_release);
+
+        hdr_->head.store(++head_, std::memory_order_release);
+    }
+
+    void publish(std::uint32_t kernel, std::initializer_list<std::int64_t> params,
+                 std::uint64_t ns, std::uint64_t c0 = 0, std::uint64_t c1 = 0) noexcept
+    {
+        Sample s;
+        s.kernel = kernel;
+        for (std::int64_t p : params) {
+            if (s.n_params == 3) break;
+            s.params[s.n_params++] = p;
+        }
+        s.ns          = ns;
+        s.counters[0] = c0;
+        s.counters[1] = c1;
+        publish(s);
+    }
+
+private:
+    Header*       hdr_   = nullptr;
+    Slot*         slots_ = nullptr;
+    std::size_t   bytes_ = 0;
+    std::uint64_t mask_  = 0;
+    std::uint64_t head_  = 0;   // private copy: the producer never reads shared state
+};
+
+/* ------------------------------------------------------------------ */
+/* Reader – read-only view used by shm_reader                         */
+/* ------------------------------------------------------------------ */
+class Reader {
+public:
+    explicit Reader(const char* name = DEFAULT_NAME)
+    {
+        int fd = ::shm_open(name, O_RDONLY, 0);
+        if (fd < 0) return;                         // producer not started yet
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+            ::close(fd);
+            return;
+        }
+        bytes_  = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return;
+
+        const Header* h = static_cast<const Header*>(p);
+        if (h->magic.load(std::memory_order_acquire) != MAGIC || h->version != VERSION ||
+            segment_bytes(h->capacity) > bytes_) {
+            ::munmap(p, bytes_);
+            return;
+        }
+        hdr_   = h;
+        slots_ = reinterpret_cast<const Slot*>(h + 1);
+    }
+
+    ~Reader()
+    {
+        if (hdr_) ::munmap(const_cast<Header*>(hdr_), bytes_);
+    }
+
+    Reader(const Reader&)            = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    bool          ok()       const { return hdr_ != nullptr; }
+    std::uint32_t capacity() const { return hdr_->capacity; }
+    std::uint64_t head()     const { return hdr_->head.load(std::memory_order_acquire); }
+
+    const char* kernel_name(std::uint32_t id) const
+    {
+        if (id == OVERFLOW_KERNEL) return "(overflow)";
+        return id < hdr_->n_kernels.load(std::memory_order_acquire) ? hdr_->names[id] : "?";
+    }
+
+    // Copy sample number `seq`; false if it is not published yet or was
+    // overwritten (before or during the copy).
+    bool read(std::uint64_t seq, Sample& out) const
+    {
+        const Slot& slot = slots_[seq & (hdr_->capacity - 1)];
+        const std::uint64_t s1 = slot.seq.load(std::memory_order_acquire);
+        if (s1 != 2 * seq + 2) return false;
+
+        std::uint64_t w[7];
+        for (int i = 0; i < 7; ++i)
+            w[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != s1) return false;
+
+        std::memcpy(&out, w, sizeof w);
+        return true;
+    }
+
+private:
+    const Header* hdr_   = nullptr;
+    const Slot*   slots_ = nullptr;
+    std::size_t   bytes_ = 0;
+};
+
+} // namespace shm_metrics